@@ -0,0 +1,240 @@
+// For CLOCK_MONOTONIC
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
+#include <unistd.h>
+#include "energy.h"
+
+#define POWERCAP_DIR "/sys/class/powercap"
+#define DRM_DIR "/sys/class/drm"
+
+static int read_u64_file(const char *path, uint64_t *out) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return -1;
+    }
+
+    // %lli also accepts hex, as used by PCI vendor files ("0x1002")
+    long long val;
+    int n = fscanf(f, "%lli", &val);
+    fclose(f);
+
+    if (n != 1 || val < 0) {
+        return -1;
+    }
+
+    *out = (uint64_t)val;
+    return 0;
+}
+
+static void energy_meter_reset(EnergyMeter *meter) {
+    memset(meter, 0, sizeof(EnergyMeter));
+    clock_gettime(CLOCK_MONOTONIC, &meter->last_sample);
+}
+
+static int energy_meter_add(EnergyMeter *meter, EnergySourceKind kind, const char *path, uint64_t max_range) {
+    if (meter->num_sources >= ENERGY_MAX_SOURCES) {
+        return -1;
+    }
+
+    // Sources that are not readable (e.g. RAPL as non-root) are silently skipped
+    uint64_t initial;
+    if (read_u64_file(path, &initial) != 0) {
+        return -1;
+    }
+
+    EnergySource *src = &meter->sources[meter->num_sources++];
+    src->kind = kind;
+    snprintf(src->path, sizeof(src->path), "%s", path);
+    src->max_range = max_range;
+    src->last = initial;
+    return 0;
+}
+
+int energy_meter_init_cpu(EnergyMeter *meter) {
+    energy_meter_reset(meter);
+
+    DIR *dir = opendir(POWERCAP_DIR);
+    if (!dir) {
+        return 0;
+    }
+
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL) {
+        // Only top-level package zones ("intel-rapl:N"), not subzones ("intel-rapl:N:M")
+        const char *name = ent->d_name;
+        if (strncmp(name, "intel-rapl:", 11) != 0 || strchr(name + 11, ':') != NULL) {
+            continue;
+        }
+
+        char path[512];
+        uint64_t max_range = 0;
+        snprintf(path, sizeof(path), POWERCAP_DIR "/%s/max_energy_range_uj", name);
+        read_u64_file(path, &max_range);
+
+        snprintf(path, sizeof(path), POWERCAP_DIR "/%s/energy_uj", name);
+        energy_meter_add(meter, ENERGY_SOURCE_COUNTER, path, max_range);
+    }
+
+    closedir(dir);
+    return (int)meter->num_sources;
+}
+
+static int add_hwmon_sources(EnergyMeter *meter, const char *card) {
+    char hwmon_dir[512];
+    snprintf(hwmon_dir, sizeof(hwmon_dir), DRM_DIR "/%s/device/hwmon", card);
+
+    DIR *dir = opendir(hwmon_dir);
+    if (!dir) {
+        return 0;
+    }
+
+    // Prefer an energy counter, fall back to sampled power
+    static const struct {
+        const char *file;
+        EnergySourceKind kind;
+    } candidates[] = {
+        { "energy1_input", ENERGY_SOURCE_COUNTER },
+        { "power1_average", ENERGY_SOURCE_POWER },
+        { "power1_input", ENERGY_SOURCE_POWER },
+    };
+
+    int added = 0;
+    struct dirent *ent;
+    while (!added && (ent = readdir(dir)) != NULL) {
+        if (strncmp(ent->d_name, "hwmon", 5) != 0) {
+            continue;
+        }
+
+        for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+            char path[512];
+            if (snprintf(path, sizeof(path), "%s/%s/%s", hwmon_dir, ent->d_name, candidates[i].file) >= (int)sizeof(path)) {
+                continue;
+            }
+            if (energy_meter_add(meter, candidates[i].kind, path, 0) == 0) {
+                added = 1;
+                break;
+            }
+        }
+    }
+
+    closedir(dir);
+    return added;
+}
+
+// PCI address of a DRM card, from the basename of its "device" link
+static int card_pci_slot(const char *card, char *out, size_t out_size) {
+    char path[512];
+    char target[512];
+    snprintf(path, sizeof(path), DRM_DIR "/%s/device", card);
+
+    ssize_t len = readlink(path, target, sizeof(target) - 1);
+    if (len < 0) {
+        return -1;
+    }
+    target[len] = '\0';
+
+    const char *base = strrchr(target, '/');
+    if (snprintf(out, out_size, "%s", base ? base + 1 : target) >= (int)out_size) {
+        return -1;
+    }
+    return 0;
+}
+
+int energy_meter_init_gpu(EnergyMeter *meter, uint32_t pci_vendor_id, const char *pci_slot) {
+    energy_meter_reset(meter);
+
+    DIR *dir = opendir(DRM_DIR);
+    if (!dir) {
+        return 0;
+    }
+
+    bool by_slot = (pci_slot && pci_slot[0] != '\0');
+    char match[256] = "";
+    int num_matches = 0;
+
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL) {
+        // Only cards ("cardN"), not connectors ("cardN-DP-1")
+        const char *name = ent->d_name;
+        if (strncmp(name, "card", 4) != 0 || strchr(name, '-') != NULL) {
+            continue;
+        }
+
+        if (by_slot) {
+            char slot[64];
+            if (card_pci_slot(name, slot, sizeof(slot)) != 0 || strcasecmp(slot, pci_slot) != 0) {
+                continue;
+            }
+        } else {
+            char path[512];
+            uint64_t vendor;
+            snprintf(path, sizeof(path), DRM_DIR "/%s/device/vendor", name);
+            if (read_u64_file(path, &vendor) != 0 || vendor != pci_vendor_id) {
+                continue;
+            }
+        }
+
+        snprintf(match, sizeof(match), "%s", name);
+        num_matches++;
+    }
+
+    closedir(dir);
+
+    // Without a PCI address, a vendor ID shared by several cards can't tell them apart
+    if (num_matches == 1) {
+        add_hwmon_sources(meter, match);
+    }
+
+    return (int)meter->num_sources;
+}
+
+bool energy_meter_available(const EnergyMeter *meter) {
+    return meter && meter->num_sources > 0;
+}
+
+double energy_meter_sample(EnergyMeter *meter) {
+    if (!energy_meter_available(meter)) {
+        return 0.0;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double dt = (now.tv_sec - meter->last_sample.tv_sec) + (now.tv_nsec - meter->last_sample.tv_nsec) / 1e9;
+    meter->last_sample = now;
+
+    for (size_t i = 0; i < meter->num_sources; i++) {
+        EnergySource *src = &meter->sources[i];
+
+        uint64_t val;
+        if (read_u64_file(src->path, &val) != 0) {
+            continue;
+        }
+
+        if (src->kind == ENERGY_SOURCE_COUNTER) {
+            uint64_t delta;
+            if (val >= src->last) {
+                delta = val - src->last;
+            } else if (src->max_range > 0) {
+                // Counter wrapped around
+                delta = (src->max_range - src->last) + val;
+            } else {
+                // Counter was reset, nothing reliable to add
+                delta = 0;
+            }
+            meter->joules += delta / 1e6;
+        } else {
+            // Trapezoidal integration of microwatt samples
+            meter->joules += ((src->last + val) / 2.0) * dt / 1e6;
+        }
+
+        src->last = val;
+    }
+
+    return meter->joules;
+}
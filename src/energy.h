@@ -0,0 +1,43 @@
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+
+#define ENERGY_MAX_SOURCES 16
+
+typedef enum {
+    ENERGY_SOURCE_COUNTER, // Cumulative microjoule counter (RAPL energy_uj, hwmon energy1_input)
+    ENERGY_SOURCE_POWER    // Instantaneous microwatt reading (hwmon power1_average / power1_input)
+} EnergySourceKind;
+
+typedef struct {
+    EnergySourceKind kind;
+    char path[512];
+    uint64_t max_range; // Counter wraparound range in microjoules (0 if unknown)
+    uint64_t last;      // Last counter or power value read
+} EnergySource;
+
+typedef struct {
+    EnergySource sources[ENERGY_MAX_SOURCES];
+    size_t num_sources;
+    struct timespec last_sample;
+    double joules;      // Energy accumulated since init
+} EnergyMeter;
+
+// CPU package energy from /sys/class/powercap (RAPL). Returns number of sources found.
+int energy_meter_init_cpu(EnergyMeter *meter);
+
+// Device energy/power from the DRM hwmon of the card at pci_slot ("0000:03:00.0").
+// Without a slot, falls back to the only card with the given PCI vendor ID; if several
+// cards share the vendor the reading is reported unavailable. Returns number of sources found.
+int energy_meter_init_gpu(EnergyMeter *meter, uint32_t pci_vendor_id, const char *pci_slot);
+
+bool energy_meter_available(const EnergyMeter *meter);
+
+// Read all sources and return total joules since init (0 if unavailable)
+double energy_meter_sample(EnergyMeter *meter);
+
+#endif
@@ -4,6 +4,24 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Vendor extensions for locating a device on the PCI bus (cl_khr_pci_bus_info,
+// cl_amd_device_attribute_query, cl_nv_device_attribute_query); not all headers define them
+#ifndef CL_DEVICE_PCI_BUS_INFO_KHR
+#define CL_DEVICE_PCI_BUS_INFO_KHR 0x410F
+#endif
+#ifndef CL_DEVICE_TOPOLOGY_AMD
+#define CL_DEVICE_TOPOLOGY_AMD 0x4037
+#endif
+#ifndef CL_DEVICE_PCI_BUS_ID_NV
+#define CL_DEVICE_PCI_BUS_ID_NV 0x4008
+#endif
+#ifndef CL_DEVICE_PCI_SLOT_ID_NV
+#define CL_DEVICE_PCI_SLOT_ID_NV 0x4009
+#endif
+#ifndef CL_DEVICE_PCI_DOMAIN_ID_NV
+#define CL_DEVICE_PCI_DOMAIN_ID_NV 0x400A
+#endif
+
 cl_device_id create_device(int platform_idx, int device_idx) {
     cl_platform_id platforms[16];
     cl_uint num_platforms;
@@ -38,6 +56,40 @@ cl_device_id create_device(int platform_idx, int device_idx) {
     return dev;
 }
 
+static void query_pci_slot(GpuSolana *gpu) {
+    gpu->pci_slot[0] = '\0';
+
+    // cl_khr_pci_bus_info: { domain, bus, device, function }
+    cl_uint khr[4];
+    if (clGetDeviceInfo(gpu->device, CL_DEVICE_PCI_BUS_INFO_KHR, sizeof(khr), khr, NULL) == CL_SUCCESS) {
+        snprintf(gpu->pci_slot, sizeof(gpu->pci_slot), "%04x:%02x:%02x.%x",
+                 khr[0] & 0xFFFF, khr[1] & 0xFF, khr[2] & 0x1F, khr[3] & 0x7);
+        return;
+    }
+
+    // cl_device_topology_amd: cl_uint type, 17 unused bytes, then bus, device, function.
+    // The domain is not reported, assume 0.
+    uint8_t amd[24];
+    if (clGetDeviceInfo(gpu->device, CL_DEVICE_TOPOLOGY_AMD, sizeof(amd), amd, NULL) == CL_SUCCESS) {
+        cl_uint type;
+        memcpy(&type, amd, sizeof(type));
+        if (type == 1) { // CL_DEVICE_TOPOLOGY_TYPE_PCIE_AMD
+            snprintf(gpu->pci_slot, sizeof(gpu->pci_slot), "0000:%02x:%02x.%x",
+                     amd[21], amd[22] & 0x1F, amd[23] & 0x7);
+        }
+        return;
+    }
+
+    // NVIDIA: bus and slot (device << 3 | function), domain only on newer drivers
+    cl_uint bus, slot, domain = 0;
+    if (clGetDeviceInfo(gpu->device, CL_DEVICE_PCI_BUS_ID_NV, sizeof(bus), &bus, NULL) == CL_SUCCESS &&
+        clGetDeviceInfo(gpu->device, CL_DEVICE_PCI_SLOT_ID_NV, sizeof(slot), &slot, NULL) == CL_SUCCESS) {
+        clGetDeviceInfo(gpu->device, CL_DEVICE_PCI_DOMAIN_ID_NV, sizeof(domain), &domain, NULL);
+        snprintf(gpu->pci_slot, sizeof(gpu->pci_slot), "%04x:%02x:%02x.%x",
+                 domain & 0xFFFF, bus & 0xFF, (slot >> 3) & 0x1F, slot & 0x7);
+    }
+}
+
 cl_program build_program(cl_context ctx, cl_device_id dev, const char *filename) {
     cl_program program;
     char *program_log;
@@ -90,6 +142,10 @@ int gpu_solana_init(GpuSolana *gpu, const GpuSolanaOptions *opts) {
     char vendor_name[256];
     clGetDeviceInfo(gpu->device, CL_DEVICE_NAME, sizeof(device_name), device_name, NULL);
     clGetDeviceInfo(gpu->device, CL_DEVICE_VENDOR, sizeof(vendor_name), vendor_name, NULL);
+    cl_uint vendor_id = 0;
+    clGetDeviceInfo(gpu->device, CL_DEVICE_VENDOR_ID, sizeof(vendor_id), &vendor_id, NULL);
+    gpu->vendor_id = vendor_id;
+    query_pci_slot(gpu);
     fprintf(stderr, "Initializing Solana GPU %s %s\n", vendor_name, device_name);
 
     // Create context
@@ -23,6 +23,8 @@ typedef struct {
     size_t global_work_size;
     size_t local_work_size;
     uint32_t num_ranges;
+    uint32_t vendor_id; // PCI vendor ID, used to locate device power readings
+    char pci_slot[16];  // PCI address ("0000:03:00.0"), empty if the driver doesn't report it
 } GpuSolana;
 
 typedef struct {
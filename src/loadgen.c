@@ -0,0 +1,420 @@
+// For CLOCK_MONOTONIC and clock_nanosleep
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <sodium.h>
+#include "argtable3.h"
+#include "solana.h"
+#include "synthetic.h"
+#include "vanity.h"
+#include "loadgen.h"
+
+typedef struct {
+    LoadgenJob *jobs;
+    size_t num_jobs;
+
+    // FIFO of job indices, filled by the dispatcher as jobs arrive
+    size_t *queue;
+    size_t queue_head;
+    size_t queue_tail;
+    bool closed;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+
+    struct timespec start;
+    double rate;
+    size_t batch;
+    double jitter;
+    double timeout;
+    uint64_t seed;
+} Loadgen;
+
+static double elapsed_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static int compare_arrival(const void *a, const void *b) {
+    double da = ((const LoadgenJob *)a)->arrival;
+    double db = ((const LoadgenJob *)b)->arrival;
+    return (da > db) - (da < db);
+}
+
+static int compare_double(const void *a, const void *b) {
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+int loadgen_parse_jobs(const char *path, LoadgenJob **jobs, size_t *num_jobs) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Couldn't open job file: %s\n", path);
+        return -1;
+    }
+
+    size_t capacity = 64;
+    size_t n = 0;
+    LoadgenJob *list = malloc(sizeof(LoadgenJob) * capacity);
+
+    char line[256];
+    size_t line_no = 0;
+    while (fgets(line, sizeof(line), f)) {
+        line_no++;
+
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+
+        double arrival_ms;
+        char prefix[64];
+        int consumed = 0;
+        int fields = sscanf(line, "%lf %63s%n", &arrival_ms, prefix, &consumed);
+        if (fields == EOF) {
+            continue; // Blank or comment-only line
+        }
+        if (fields < 2 || arrival_ms < 0) {
+            fprintf(stderr, "%s:%zu: expected \"ARRIVAL_MS PREFIX [LIMIT]\"\n", path, line_no);
+            goto fail;
+        }
+
+        // Optional LIMIT, then nothing but whitespace (strtoull would accept "-1" as a huge value)
+        size_t limit = 1;
+        char *rest = line + consumed;
+        while (isspace((unsigned char)*rest)) rest++;
+        if (*rest != '\0') {
+            char *endp;
+            errno = 0;
+            unsigned long long val = (*rest == '-') ? 0 : strtoull(rest, &endp, 10);
+            if (*rest == '-' || endp == rest || errno != 0 || val > SIZE_MAX) {
+                fprintf(stderr, "%s:%zu: invalid limit\n", path, line_no);
+                goto fail;
+            }
+            limit = (size_t)val;
+
+            rest = endp;
+            while (isspace((unsigned char)*rest)) rest++;
+            if (*rest != '\0') {
+                fprintf(stderr, "%s:%zu: unexpected text after limit\n", path, line_no);
+                goto fail;
+            }
+        }
+
+        // Reject prefixes the engine couldn't run
+        SolanaMatcher matcher;
+        if (prefix_to_all_ranges(prefix, &matcher) != 0) {
+            fprintf(stderr, "%s:%zu: invalid prefix: %s\n", path, line_no, prefix);
+            goto fail;
+        }
+        solana_matcher_free(&matcher);
+
+        if (n == capacity) {
+            capacity *= 2;
+            list = realloc(list, sizeof(LoadgenJob) * capacity);
+        }
+
+        LoadgenJob *job = &list[n++];
+        memset(job, 0, sizeof(LoadgenJob));
+        job->line = line_no;
+        job->arrival = arrival_ms / 1000.0;
+        snprintf(job->prefix, sizeof(job->prefix), "%s", prefix);
+        job->limit = limit;
+        job->first_result = -1.0;
+    }
+
+    fclose(f);
+
+    if (n == 0) {
+        fprintf(stderr, "No jobs in %s\n", path);
+        free(list);
+        return -1;
+    }
+
+    qsort(list, n, sizeof(LoadgenJob), compare_arrival);
+    *jobs = list;
+    *num_jobs = n;
+    return 0;
+
+fail:
+    fclose(f);
+    free(list);
+    return -1;
+}
+
+static void run_job(Loadgen *lg, LoadgenJob *job, size_t job_idx, uint8_t *pubkeys) {
+    SolanaMatcher matcher;
+    prefix_to_all_ranges(job->prefix, &matcher);
+
+    SyntheticBackend backend;
+    synthetic_init(&backend, lg->rate, lg->batch, lg->jitter, lg->seed + job_idx);
+
+    char address[64];
+
+    job->started = elapsed_since(&lg->start);
+
+    // Same match/confirm step as the search workers
+    bool done = false;
+    while (!done) {
+        size_t n = synthetic_next_batch(&backend, pubkeys);
+        size_t examined = n;
+
+        for (size_t i = match_pubkey_batch(&matcher, job->prefix, pubkeys, 0, n, address);
+             i < n;
+             i = match_pubkey_batch(&matcher, job->prefix, pubkeys, i + 1, n, address)) {
+            if (job->found++ == 0) {
+                job->first_result = elapsed_since(&lg->start);
+            }
+            if (job->limit != 0 && job->found >= job->limit) {
+                examined = i + 1;
+                done = true;
+                break;
+            }
+        }
+        job->attempts += examined;
+        job->generated += n;
+
+        if (lg->timeout > 0 && elapsed_since(&lg->start) - job->started >= lg->timeout) {
+            done = true;
+        }
+    }
+
+    job->finished = elapsed_since(&lg->start);
+    solana_matcher_free(&matcher);
+}
+
+static void* loadgen_worker_thread(void *arg) {
+    Loadgen *lg = (Loadgen *)arg;
+
+    uint8_t *pubkeys = malloc(lg->batch * SOLANA_PUBKEY_SIZE);
+    if (!pubkeys) {
+        fprintf(stderr, "Couldn't allocate a synthetic batch of %zu keys\n", lg->batch);
+        exit(1);
+    }
+
+    while (1) {
+        pthread_mutex_lock(&lg->lock);
+        while (lg->queue_head == lg->queue_tail && !lg->closed) {
+            pthread_cond_wait(&lg->cond, &lg->lock);
+        }
+        if (lg->queue_head == lg->queue_tail) {
+            pthread_mutex_unlock(&lg->lock);
+            break; // Closed and drained
+        }
+        size_t idx = lg->queue[lg->queue_head++];
+        LoadgenJob *job = &lg->jobs[idx];
+        job->picked = elapsed_since(&lg->start);
+        pthread_mutex_unlock(&lg->lock);
+
+        run_job(lg, job, idx, pubkeys);
+        job->released = elapsed_since(&lg->start);
+    }
+
+    free(pubkeys);
+    return NULL;
+}
+
+static void print_percentiles(const char *label, double *values, size_t n, double scale) {
+    if (n == 0) {
+        fprintf(stderr, "  %-26s %12s\n", label, "n/a");
+        return;
+    }
+
+    qsort(values, n, sizeof(double), compare_double);
+
+    // Nearest-rank percentiles
+    const double ps[] = { 0.50, 0.90, 0.99 };
+    fprintf(stderr, "  %-26s", label);
+    for (size_t i = 0; i < sizeof(ps) / sizeof(ps[0]); i++) {
+        size_t rank = (size_t)ceil(ps[i] * n);
+        fprintf(stderr, " %12.3f", values[rank > 0 ? rank - 1 : 0] * scale);
+    }
+    fprintf(stderr, " %12.3f\n", values[n - 1] * scale);
+}
+
+int loadgen_main(int argc, char *argv[]) {
+    struct arg_lit  *help    = arg_lit0("h", "help", "display this help and exit");
+    struct arg_file *jobfile = arg_file1(NULL, NULL, "JOBFILE", "Job mix: one \"ARRIVAL_MS PREFIX [LIMIT]\" job per line");
+    struct arg_int  *workers = arg_int0("w", "workers", "N", "Number of jobs served concurrently [default: 4]");
+    struct arg_int  *rate    = arg_int0(NULL, "rate", "N", "Synthetic keys/s per worker, 0 for unthrottled [default: 1000000]");
+    struct arg_int  *batch   = arg_int0(NULL, "batch", "N", "Synthetic keys per batch [default: 65536]");
+    struct arg_dbl  *jitter  = arg_dbl0(NULL, "jitter", "F", "Relative batch latency jitter, 0.0 - 1.0 [default: 0.1]");
+    struct arg_dbl  *timeout = arg_dbl0(NULL, "timeout", "SECONDS", "Give up on a job after searching this long (0 for never)");
+    struct arg_int  *seed    = arg_int0(NULL, "seed", "N", "Seed for reproducible synthetic keys [default: random]");
+    struct arg_lit  *verbose = arg_lit0("v", "verbose", "Print per-job measurements");
+    struct arg_end  *end     = arg_end(20);
+
+    void *argtable[] = { jobfile, workers, rate, batch, jitter, timeout, seed, verbose, help, end };
+
+    const char *progname = "solana-vanity loadgen";
+
+    workers->ival[0] = 4;
+    rate->ival[0] = 1000000;
+    batch->ival[0] = 65536;
+    jitter->dval[0] = 0.1;
+    timeout->dval[0] = 0.0;
+
+    int nerrors = arg_parse(argc, argv, argtable);
+
+    if (help->count > 0) {
+        printf("Usage: %s", progname);
+        arg_print_syntax(stdout, argtable, "\n");
+        printf("%s\n\n", "Replay a job mix against the search engine using a synthetic key backend");
+        arg_print_glossary(stdout, argtable, "  %-25s %s\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 0;
+    }
+
+    if (nerrors > 0) {
+        arg_print_errors(stdout, end, progname);
+        printf("Try '%s --help' for more information.\n", progname);
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (workers->ival[0] < 1 || batch->ival[0] < 1 || rate->ival[0] < 0 ||
+        jitter->dval[0] < 0.0 || jitter->dval[0] > 1.0) {
+        fprintf(stderr, "--workers and --batch must be positive, --rate non-negative, --jitter within 0.0 - 1.0\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    Loadgen lg;
+    memset(&lg, 0, sizeof(Loadgen));
+    if (loadgen_parse_jobs(jobfile->filename[0], &lg.jobs, &lg.num_jobs) != 0) {
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    for (size_t i = 0; i < lg.num_jobs; i++) {
+        if (lg.jobs[i].limit == 0 && timeout->dval[0] <= 0) {
+            fprintf(stderr, "%s:%zu: job %s has no limit; set --timeout to bound it\n",
+                    jobfile->filename[0], lg.jobs[i].line, lg.jobs[i].prefix);
+            free(lg.jobs);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+    }
+
+    size_t num_workers = workers->ival[0];
+    lg.queue = malloc(sizeof(size_t) * lg.num_jobs);
+    lg.rate = rate->ival[0];
+    lg.batch = batch->ival[0];
+    lg.jitter = jitter->dval[0];
+    lg.timeout = timeout->dval[0];
+    if (seed->count > 0) {
+        lg.seed = (uint64_t)seed->ival[0];
+    } else {
+        randombytes_buf(&lg.seed, sizeof(lg.seed));
+    }
+    pthread_mutex_init(&lg.lock, NULL);
+    pthread_cond_init(&lg.cond, NULL);
+
+    fprintf(stderr, "Replaying %zu job(s) on %zu worker(s), %.0f synthetic keys/s each, batch %zu\n\n",
+            lg.num_jobs, num_workers, lg.rate, lg.batch);
+    fflush(stderr);
+
+    clock_gettime(CLOCK_MONOTONIC, &lg.start);
+
+    pthread_t *threads = malloc(sizeof(pthread_t) * num_workers);
+    for (size_t i = 0; i < num_workers; i++) {
+        pthread_create(&threads[i], NULL, loadgen_worker_thread, &lg);
+    }
+
+    // Dispatch jobs at their arrival times
+    for (size_t i = 0; i < lg.num_jobs; i++) {
+        struct timespec when = lg.start;
+        long long nsec = when.tv_nsec + (long long)(lg.jobs[i].arrival * 1e9);
+        when.tv_sec += nsec / 1000000000LL;
+        when.tv_nsec = nsec % 1000000000LL;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &when, NULL) == EINTR) {
+            // Interrupted by a signal, keep waiting for the arrival time
+        }
+
+        pthread_mutex_lock(&lg.lock);
+        lg.jobs[i].enqueued = elapsed_since(&lg.start);
+        lg.queue[lg.queue_tail++] = i;
+        pthread_cond_signal(&lg.cond);
+        pthread_mutex_unlock(&lg.lock);
+    }
+
+    pthread_mutex_lock(&lg.lock);
+    lg.closed = true;
+    pthread_cond_broadcast(&lg.cond);
+    pthread_mutex_unlock(&lg.lock);
+
+    for (size_t i = 0; i < num_workers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double wall = elapsed_since(&lg.start);
+
+    // Collect measurements
+    double *queue_latency = malloc(sizeof(double) * lg.num_jobs);
+    double *first_result = malloc(sizeof(double) * lg.num_jobs);
+    double *overhead = malloc(sizeof(double) * lg.num_jobs);
+    size_t num_first = 0;
+    size_t num_unfinished = 0;
+    uint64_t total_attempts = 0;
+    uint64_t total_generated = 0;
+
+    for (size_t i = 0; i < lg.num_jobs; i++) {
+        LoadgenJob *job = &lg.jobs[i];
+
+        // Queue latency starts at enqueue so dispatch lag is only counted as overhead
+        queue_latency[i] = job->picked - job->enqueued;
+        // Time neither spent queued behind other jobs nor searching:
+        // dispatch lag, matcher setup and teardown
+        overhead[i] = (job->enqueued - job->arrival) + (job->started - job->picked) + (job->released - job->finished);
+        if (job->first_result >= 0) {
+            first_result[num_first++] = job->first_result - job->arrival;
+        }
+        if (job->limit == 0 || job->found < job->limit) {
+            num_unfinished++;
+        }
+        total_attempts += job->attempts;
+        total_generated += job->generated;
+
+        if (verbose->count > 0) {
+            fprintf(stderr, "Job at line %zu: %s limit %zu, arrival %.3f ms, queued %.3f ms, first result ",
+                    job->line, job->prefix, job->limit, job->arrival * 1e3, queue_latency[i] * 1e3);
+            if (job->first_result >= 0) {
+                fprintf(stderr, "%.3f ms", (job->first_result - job->arrival) * 1e3);
+            } else {
+                fprintf(stderr, "none");
+            }
+            fprintf(stderr, ", found %zu in %lu keys\n", job->found, job->attempts);
+        }
+    }
+
+    if (verbose->count > 0) {
+        fprintf(stderr, "\n");
+    }
+
+    fprintf(stderr, "Jobs: %zu completed, %zu stopped by timeout\n", lg.num_jobs - num_unfinished, num_unfinished);
+    fprintf(stderr, "Wall time: %.3f s, synthetic keys generated: %lu (%.1f keys/s), examined: %lu\n\n",
+            wall, total_generated, wall > 0 ? total_generated / wall : 0.0, total_attempts);
+    fprintf(stderr, "  %-26s %12s %12s %12s %12s\n", "", "p50", "p90", "p99", "max");
+    print_percentiles("Queue latency (ms)", queue_latency, lg.num_jobs, 1e3);
+    print_percentiles("Time to first result (ms)", first_result, num_first, 1e3);
+    print_percentiles("Scheduler overhead (us)", overhead, lg.num_jobs, 1e6);
+
+    free(queue_latency);
+    free(first_result);
+    free(overhead);
+    free(threads);
+    free(lg.queue);
+    free(lg.jobs);
+    pthread_mutex_destroy(&lg.lock);
+    pthread_cond_destroy(&lg.cond);
+    arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef LOADGEN_H
+#define LOADGEN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct {
+    size_t line;         // Line in the job file, for reporting
+    double arrival;      // Scheduled arrival, seconds from start
+    char prefix[64];
+    size_t limit;        // Matches to find before the job completes (0 = until timeout)
+
+    // Timestamps in seconds from start, filled in as the job runs
+    double enqueued;     // Handed to the queue by the dispatcher
+    double picked;       // Taken off the queue by a worker
+    double started;      // Matcher compiled, search loop entered
+    double first_result; // First confirmed match (< 0 if none)
+    double finished;     // Search loop left
+    double released;     // Worker done with the job
+    size_t found;
+    uint64_t attempts;   // Keys examined up to the match that completed the job
+    uint64_t generated;  // Keys produced, including the rest of the final batch
+} LoadgenJob;
+
+// Parse a job mix file: one "ARRIVAL_MS PREFIX [LIMIT]" job per line, '#' starts a comment.
+// Jobs are returned sorted by arrival. Returns 0 on success.
+int loadgen_parse_jobs(const char *path, LoadgenJob **jobs, size_t *num_jobs);
+
+// Entry point for the "loadgen" subcommand
+int loadgen_main(int argc, char *argv[]);
+
+#endif
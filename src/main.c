@@ -8,6 +8,8 @@
 #include "solana.h"
 #include "gpu.h"
 #include "vanity.h"
+#include "loadgen.h"
+#include "verify.h"
 
 int main(int argc, char *argv[]) {
     // Initialize libsodium
@@ -15,6 +17,16 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "Failed to initialize libsodium\n");
         return 1;
     }
+
+    // Subcommands ("loadgen" contains 'l', so it can never be a Base58 prefix;
+    // "verify" shadows the prefix of the same name)
+    if (argc > 1 && strcmp(argv[1], "loadgen") == 0) {
+        return loadgen_main(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+        return verify_main(argc - 1, argv + 1);
+    }
+
     // 1. Declare the argtable structures
     struct arg_lit  *help    = arg_lit0("h", "help", "display this help and exit");
     struct arg_lit  *version = arg_lit0(NULL, "version", "display version info and exit");
@@ -35,6 +47,12 @@ int main(int argc, char *argv[]) {
     // Optional flags
     struct arg_lit  *no_progress = arg_lit0(NULL, "no-progress", "Disable progress output");
     struct arg_lit  *simple_output = arg_lit0(NULL, "simple-output", "Output found keys in the form \"[key] [address]\"");
+    struct arg_lit  *energy = arg_lit0(NULL, "energy", "Report keys per joule using RAPL and GPU power readings, where available");
+
+    // Optional arguments for benchmarking without real key derivation
+    struct arg_int  *synthetic_rate = arg_int0(NULL, "synthetic-rate", "N", "Replace CPU threads with a synthetic backend producing N pseudo-random keys/s each (0 for unthrottled)");
+    struct arg_int  *synthetic_batch = arg_int0(NULL, "synthetic-batch", "N", "Keys per synthetic batch [default: 65536]");
+    struct arg_dbl  *synthetic_jitter = arg_dbl0(NULL, "synthetic-jitter", "F", "Relative synthetic batch latency jitter, 0.0 - 1.0 [default: 0.1]");
 
     // Optional arguments for GPU device selection
     struct arg_int  *gpu_platform = arg_int0(NULL, "gpu-platform", "INDEX", "The GPU platform to use");
@@ -46,8 +64,8 @@ int main(int argc, char *argv[]) {
     // 2. Define the argtable array
     void *argtable[] = {
         prefix, threads, gpu, limit, gpu_threads, gpu_local_work_size,
-        gpu_global_work_size, no_progress, simple_output, gpu_platform,
-        gpu_device, help, version, end
+        gpu_global_work_size, no_progress, simple_output, energy, synthetic_rate,
+        synthetic_batch, synthetic_jitter, gpu_platform, gpu_device, help, version, end
     };
 
     const char *progname = "solana-vanity"; // argv[0]
@@ -57,6 +75,8 @@ int main(int argc, char *argv[]) {
     gpu_threads->ival[0] = 1048576;
     gpu_platform->ival[0] = 0;
     gpu_device->ival[0] = 0;
+    synthetic_batch->ival[0] = 65536;
+    synthetic_jitter->dval[0] = 0.1;
     // threads default is dynamic, so we'd set it after parsing if not present.
 
     // 3. Parse the command line
@@ -68,6 +88,11 @@ int main(int argc, char *argv[]) {
         arg_print_syntax(stdout, argtable, "\n");
         printf("%s\n\n", "Generate SOLANA addresses with a given prefix");
         arg_print_glossary(stdout, argtable, "  %-25s %s\n");
+        printf("\nSubcommands (see '%s <subcommand> --help'):\n", progname);
+        printf("  %-25s %s\n", "loadgen JOBFILE", "Replay a job mix against the search engine with synthetic keys");
+        printf("  %-25s %s\n", "verify FILE", "Re-derive every keypair in an output file and report mismatches");
+        printf("\nA first argument of \"verify\" runs the subcommand. To search for the prefix\n"
+               "\"verify\", put \"--\" or any option before it, e.g. '%s -- verify'.\n", progname);
         return 0;
     }
     if (version->count > 0) {
@@ -88,6 +113,20 @@ int main(int argc, char *argv[]) {
     bool use_gpu = (gpu->count > 0);
     bool output_progress = (no_progress->count == 0);
     bool simple_output_flag = (simple_output->count > 0);
+    bool energy_flag = (energy->count > 0);
+    bool use_synthetic = (synthetic_rate->count > 0);
+
+    if ((synthetic_batch->count > 0 || synthetic_jitter->count > 0) && !use_synthetic) {
+        fprintf(stderr, "--synthetic-batch and --synthetic-jitter require --synthetic-rate\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+    if (use_synthetic && (synthetic_rate->ival[0] < 0 || synthetic_batch->ival[0] < 1 ||
+                          synthetic_jitter->dval[0] < 0.0 || synthetic_jitter->dval[0] > 1.0)) {
+        fprintf(stderr, "--synthetic-batch must be positive, --synthetic-rate non-negative, --synthetic-jitter within 0.0 - 1.0\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
 
     int num_threads = threads->count > 0 ? threads->ival[0] : (sysconf(_SC_NPROCESSORS_ONLN) - 1);
     if (num_threads < 1) num_threads = 1;
@@ -102,7 +141,8 @@ int main(int argc, char *argv[]) {
 
     // Setup shared state
     atomic_size_t found_n = 0;
-    atomic_size_t attempts = 0;
+    atomic_size_t cpu_attempts = 0;
+    atomic_size_t gpu_attempts = 0;
 
     // Print search info BEFORE starting threads
     if (!simple_output_flag) {
@@ -150,15 +190,30 @@ int main(int argc, char *argv[]) {
     // Allocate and prepare CPU thread parameters (but don't start threads yet)
     pthread_t *cpu_threads = malloc(sizeof(pthread_t) * num_threads);
     ThreadParams *cpu_params = malloc(sizeof(ThreadParams) * num_threads);
+    SyntheticThreadParams *synth_params = use_synthetic ? malloc(sizeof(SyntheticThreadParams) * num_threads) : NULL;
 
     for (int i = 0; i < num_threads; i++) {
         cpu_params[i].limit = limit_val;
         cpu_params[i].found_n = &found_n;
         cpu_params[i].output_progress = output_progress;
-        cpu_params[i].attempts = &attempts;
+        cpu_params[i].attempts = &cpu_attempts;
         cpu_params[i].simple_output = simple_output_flag;
         cpu_params[i].matcher = &matcher;
         cpu_params[i].prefix = prefix_str;
+
+        if (use_synthetic) {
+            uint64_t seed;
+            randombytes_buf(&seed, sizeof(seed));
+            synthetic_init(&synth_params[i].backend, synthetic_rate->ival[0], synthetic_batch->ival[0],
+                           synthetic_jitter->dval[0], seed);
+            synth_params[i].limit = limit_val;
+            synth_params[i].found_n = &found_n;
+            synth_params[i].output_progress = output_progress;
+            synth_params[i].attempts = &cpu_attempts;
+            synth_params[i].simple_output = simple_output_flag;
+            synth_params[i].matcher = &matcher;
+            synth_params[i].prefix = prefix_str;
+        }
     }
 
     // Prepare GPU thread if requested (but don't start yet)
@@ -182,7 +237,7 @@ int main(int argc, char *argv[]) {
             gpu_params.limit = limit_val;
             gpu_params.found_n = &found_n;
             gpu_params.output_progress = output_progress;
-            gpu_params.attempts = &attempts;
+            gpu_params.attempts = &gpu_attempts;
             gpu_params.simple_output = simple_output_flag;
             gpu_params.prefix = prefix_str;
             gpu_params.gpu_threads = gpu_threads->ival[0];
@@ -193,6 +248,34 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    // Setup energy accounting (a no-op for backends without readable sources)
+    EnergyMeter cpu_energy, gpu_energy;
+    ProgressParams progress_params = {
+        .cpu_attempts = &cpu_attempts,
+        .gpu_attempts = &gpu_attempts,
+        .cpu_energy = NULL,
+        .gpu_energy = NULL
+    };
+
+    if (energy_flag && !output_progress) {
+        // Keys per joule is only reported on the progress line
+        fprintf(stderr, "Note: --energy has no effect with --no-progress\n");
+    } else if (energy_flag) {
+        if (energy_meter_init_cpu(&cpu_energy) > 0) {
+            progress_params.cpu_energy = &cpu_energy;
+        } else if (!simple_output_flag) {
+            fprintf(stderr, "Note: CPU energy readings unavailable (no readable RAPL domains)\n");
+        }
+
+        if (gpu_ready) {
+            if (energy_meter_init_gpu(&gpu_energy, gpu_ctx.vendor_id, gpu_ctx.pci_slot) > 0) {
+                progress_params.gpu_energy = &gpu_energy;
+            } else if (!simple_output_flag) {
+                fprintf(stderr, "Note: GPU power readings unavailable for this device (no hwmon, or card not identifiable)\n");
+            }
+        }
+    }
+
     // NOW start all threads (after everything is printed)
     // Flush both stdout and stderr to ensure all output appears in order
     fflush(stdout);
@@ -201,12 +284,16 @@ int main(int argc, char *argv[]) {
     // Start progress thread first
     pthread_t progress_thd;
     if (output_progress) {
-        pthread_create(&progress_thd, NULL, progress_thread, &attempts);
+        pthread_create(&progress_thd, NULL, progress_thread, &progress_params);
     }
 
     // Start CPU worker threads
     for (int i = 0; i < num_threads; i++) {
-        pthread_create(&cpu_threads[i], NULL, cpu_worker_thread, &cpu_params[i]);
+        if (use_synthetic) {
+            pthread_create(&cpu_threads[i], NULL, synthetic_worker_thread, &synth_params[i]);
+        } else {
+            pthread_create(&cpu_threads[i], NULL, cpu_worker_thread, &cpu_params[i]);
+        }
     }
 
     // Start GPU worker thread
@@ -227,6 +314,7 @@ int main(int argc, char *argv[]) {
     // Cleanup
     free(cpu_threads);
     free(cpu_params);
+    free(synth_params);
     solana_matcher_free(&matcher);
     arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
 
@@ -0,0 +1,85 @@
+// For CLOCK_MONOTONIC and clock_nanosleep
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include "synthetic.h"
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+uint64_t synthetic_rand(SyntheticBackend *synth) {
+    uint64_t *s = synth->rng;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+void synthetic_init(SyntheticBackend *synth, double keys_per_second, size_t batch_size, double jitter, uint64_t seed) {
+    synth->keys_per_second = keys_per_second;
+    synth->batch_size = batch_size > 0 ? batch_size : 1;
+    synth->jitter = jitter < 0.0 ? 0.0 : (jitter > 1.0 ? 1.0 : jitter);
+
+    for (int i = 0; i < 4; i++) {
+        synth->rng[i] = splitmix64(&seed);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &synth->next_deadline);
+}
+
+size_t synthetic_next_batch(SyntheticBackend *synth, uint8_t *pubkeys) {
+    // Deadlines are absolute so generation time is absorbed into the batch latency,
+    // but a stalled caller restarts the schedule instead of bursting to catch up
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (synth->next_deadline.tv_sec < now.tv_sec ||
+        (synth->next_deadline.tv_sec == now.tv_sec && synth->next_deadline.tv_nsec < now.tv_nsec)) {
+        synth->next_deadline = now;
+    }
+
+    // Pseudo-random bytes stand in for derived pubkeys
+    size_t words = synth->batch_size * SOLANA_PUBKEY_SIZE / sizeof(uint64_t);
+    for (size_t i = 0; i < words; i++) {
+        uint64_t r = synthetic_rand(synth);
+        memcpy(pubkeys + i * sizeof(uint64_t), &r, sizeof(uint64_t));
+    }
+
+    if (synth->keys_per_second <= 0) {
+        return synth->batch_size; // Unthrottled
+    }
+
+    // Batch latency = batch_size / rate, scaled by a uniform factor in [1 - jitter, 1 + jitter]
+    double latency = synth->batch_size / synth->keys_per_second;
+    if (synth->jitter > 0) {
+        double u = (synthetic_rand(synth) >> 11) * (1.0 / 9007199254740992.0); // [0, 1)
+        latency *= 1.0 + synth->jitter * (2.0 * u - 1.0);
+    }
+
+    long long nsec = synth->next_deadline.tv_nsec + (long long)(latency * 1e9);
+    synth->next_deadline.tv_sec += nsec / 1000000000LL;
+    synth->next_deadline.tv_nsec = nsec % 1000000000LL;
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &synth->next_deadline, NULL) == EINTR) {
+        // Interrupted by a signal, keep waiting for the deadline
+    }
+
+    return synth->batch_size;
+}
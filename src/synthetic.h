@@ -0,0 +1,27 @@
+#ifndef SYNTHETIC_H
+#define SYNTHETIC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "solana.h"
+
+typedef struct {
+    double keys_per_second; // Simulated derivation rate
+    size_t batch_size;      // Pubkeys produced per batch
+    double jitter;          // Relative batch latency jitter (0.0 - 1.0)
+    uint64_t rng[4];        // xoshiro256** state
+    struct timespec next_deadline;
+} SyntheticBackend;
+
+void synthetic_init(SyntheticBackend *synth, double keys_per_second, size_t batch_size, double jitter, uint64_t seed);
+
+// Fill pubkeys (batch_size * SOLANA_PUBKEY_SIZE bytes) with pseudo-random pubkeys.
+// Blocks until the batch latency implied by the configured rate has elapsed.
+size_t synthetic_next_batch(SyntheticBackend *synth, uint8_t *pubkeys);
+
+uint64_t synthetic_rand(SyntheticBackend *synth);
+
+#endif
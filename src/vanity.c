@@ -10,6 +10,28 @@
 #include <sodium.h>
 #include "vanity.h"
 
+size_t match_pubkey_batch(const SolanaMatcher *matcher, const char *prefix,
+                          const uint8_t *pubkeys, size_t from, size_t n, char *address) {
+    size_t prefix_len = strlen(prefix);
+
+    for (size_t i = from; i < n; i++) {
+        const uint8_t *pubkey = pubkeys + i * SOLANA_PUBKEY_SIZE;
+
+        // Fast byte-level check (no base58 conversion needed)
+        if (!solana_matcher_matches(matcher, pubkey)) {
+            continue;
+        }
+
+        // Verify it's a real match by checking the base58 address
+        pubkey_to_base58(pubkey, address);
+        if (strncmp(address, prefix, prefix_len) == 0) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
 // CPU worker thread
 void* cpu_worker_thread(void *arg) {
     ThreadParams *params = (ThreadParams *)arg;
@@ -25,37 +47,31 @@ void* cpu_worker_thread(void *arg) {
         // Generate public key from private key
         secret_to_pubkey_solana(key, pubkey);
 
-        // Fast byte-level check (no base58 conversion needed)
-        if (solana_matcher_matches(params->matcher, pubkey)) {
-            // Verify it's a real match by checking the base58 address
-            pubkey_to_base58(pubkey, address);
+        if (match_pubkey_batch(params->matcher, params->prefix, pubkey, 0, 1, address) == 0) {
+            if (params->output_progress) {
+                fprintf(stderr, "\n");
+            }
 
-            if (strncmp(address, params->prefix, strlen(params->prefix)) == 0) {
-                if (params->output_progress) {
-                    fprintf(stderr, "\n");
+            // Print result (to stdout for simple output, stderr for verbose)
+            if (params->simple_output) {
+                for (int i = 0; i < SOLANA_PRIVKEY_SIZE; i++) {
+                    printf("%02X", key[i]);
                 }
-
-                // Print result (to stdout for simple output, stderr for verbose)
-                if (params->simple_output) {
-                    for (int i = 0; i < SOLANA_PRIVKEY_SIZE; i++) {
-                        printf("%02X", key[i]);
-                    }
-                    printf(" %s\n", address);
-                    fflush(stdout);
-                } else {
-                    fprintf(stderr, "Found matching account!\nPrivate Key: ");
-                    for (int i = 0; i < SOLANA_PRIVKEY_SIZE; i++) {
-                        fprintf(stderr, "%02X", key[i]);
-                    }
-                    fprintf(stderr, "\nAddress:     %s\n", address);
-                    fflush(stderr);
+                printf(" %s\n", address);
+                fflush(stdout);
+            } else {
+                fprintf(stderr, "Found matching account!\nPrivate Key: ");
+                for (int i = 0; i < SOLANA_PRIVKEY_SIZE; i++) {
+                    fprintf(stderr, "%02X", key[i]);
                 }
+                fprintf(stderr, "\nAddress:     %s\n", address);
+                fflush(stderr);
+            }
 
-                // Check if we've reached the limit
-                size_t found = atomic_fetch_add(params->found_n, 1) + 1;
-                if (params->limit != 0 && found >= params->limit) {
-                    exit(0);
-                }
+            // Check if we've reached the limit
+            size_t found = atomic_fetch_add(params->found_n, 1) + 1;
+            if (params->limit != 0 && found >= params->limit) {
+                exit(0);
             }
         }
 
@@ -143,9 +159,55 @@ void* gpu_worker_thread(void *arg) {
     return NULL;
 }
 
+// Synthetic worker thread: exercises matching and reporting without key derivation
+void* synthetic_worker_thread(void *arg) {
+    SyntheticThreadParams *params = (SyntheticThreadParams *)arg;
+
+    uint8_t *pubkeys = malloc(params->backend.batch_size * SOLANA_PUBKEY_SIZE);
+    if (!pubkeys) {
+        fprintf(stderr, "Couldn't allocate a synthetic batch of %zu keys\n", params->backend.batch_size);
+        exit(1);
+    }
+
+    char address[64];
+
+    while (1) {
+        size_t n = synthetic_next_batch(&params->backend, pubkeys);
+
+        for (size_t i = match_pubkey_batch(params->matcher, params->prefix, pubkeys, 0, n, address);
+             i < n;
+             i = match_pubkey_batch(params->matcher, params->prefix, pubkeys, i + 1, n, address)) {
+            if (params->output_progress) {
+                fprintf(stderr, "\n");
+            }
+
+            // There is no private key behind a synthetic pubkey
+            if (params->simple_output) {
+                printf("synthetic %s\n", address);
+                fflush(stdout);
+            } else {
+                fprintf(stderr, "Found matching synthetic account!\nAddress:     %s\n", address);
+                fflush(stderr);
+            }
+
+            size_t found = atomic_fetch_add(params->found_n, 1) + 1;
+            if (params->limit != 0 && found >= params->limit) {
+                exit(0);
+            }
+        }
+
+        if (params->output_progress) {
+            atomic_fetch_add(params->attempts, n);
+        }
+    }
+
+    free(pubkeys);
+    return NULL;
+}
+
 // Progress reporting thread
 void* progress_thread(void *arg) {
-    atomic_size_t *attempts = (atomic_size_t *)arg;
+    ProgressParams *params = (ProgressParams *)arg;
 
     struct timespec start, now;
     clock_gettime(CLOCK_MONOTONIC, &start);
@@ -153,7 +215,9 @@ void* progress_thread(void *arg) {
     while (1) {
         usleep(250000); // Sleep 250ms
 
-        size_t attempts_val = atomic_load(attempts);
+        size_t cpu_attempts = atomic_load(params->cpu_attempts);
+        size_t gpu_attempts = atomic_load(params->gpu_attempts);
+        size_t attempts_val = cpu_attempts + gpu_attempts;
         clock_gettime(CLOCK_MONOTONIC, &now);
 
         double elapsed = (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
@@ -162,6 +226,17 @@ void* progress_thread(void *arg) {
         double keys_per_second = (elapsed > 0) ? (attempts_val / elapsed) : 0.0;
 
         fprintf(stderr, "\rTried %zu keys (%.1f keys/s)", attempts_val, keys_per_second);
+
+        // Keys per joule for each backend with a readable energy source
+        if (energy_meter_available(params->cpu_energy)) {
+            double joules = energy_meter_sample(params->cpu_energy);
+            fprintf(stderr, " | CPU %.1f keys/J", (joules > 0) ? (cpu_attempts / joules) : 0.0);
+        }
+        if (energy_meter_available(params->gpu_energy)) {
+            double joules = energy_meter_sample(params->gpu_energy);
+            fprintf(stderr, " | GPU %.1f keys/J", (joules > 0) ? (gpu_attempts / joules) : 0.0);
+        }
+
         fflush(stderr);
     }
 
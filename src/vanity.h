@@ -9,6 +9,8 @@
 
 #include "solana.h"
 #include "gpu.h"
+#include "energy.h"
+#include "synthetic.h"
 
 typedef struct {
     size_t limit;
@@ -31,8 +33,32 @@ typedef struct {
     size_t gpu_threads;
 } GpuThreadParams;
 
+typedef struct {
+    SyntheticBackend backend;
+    size_t limit;
+    atomic_size_t *found_n;
+    bool output_progress;
+    atomic_size_t *attempts;
+    bool simple_output;
+    const SolanaMatcher *matcher;
+    const char *prefix;
+} SyntheticThreadParams;
+
+typedef struct {
+    atomic_size_t *cpu_attempts;
+    atomic_size_t *gpu_attempts;
+    EnergyMeter *cpu_energy; // NULL when energy accounting is disabled
+    EnergyMeter *gpu_energy; // NULL when energy accounting is disabled or no GPU
+} ProgressParams;
+
+// Scan pubkeys[from..n) with the byte-range matcher, confirming hits via Base58.
+// Returns the index of the next confirmed match (with its address written out), or n if none.
+size_t match_pubkey_batch(const SolanaMatcher *matcher, const char *prefix,
+                          const uint8_t *pubkeys, size_t from, size_t n, char *address);
+
 void* cpu_worker_thread(void *arg);
 void* gpu_worker_thread(void *arg);
+void* synthetic_worker_thread(void *arg);
 void* progress_thread(void *arg);
 
 #endif
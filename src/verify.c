@@ -0,0 +1,445 @@
+// For CLOCK_MONOTONIC and madvise
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "argtable3.h"
+#include "solana.h"
+#include "vanity.h"
+#include "verify.h"
+
+#define VERIFY_RECORD_SIZE (SOLANA_PRIVKEY_SIZE + SOLANA_PUBKEY_SIZE)
+
+typedef struct {
+    const uint8_t *data;
+    size_t begin;             // Byte range of this chunk
+    size_t end;
+    size_t first_record;      // Line number (text) or record index (binary) at begin
+    VerifyFormat format;
+    const SolanaMatcher *matcher; // NULL when no pattern check was requested
+    const char *prefix;
+    size_t records;
+    size_t mismatches;
+    FILE *out;                // Mismatch report, printed in chunk order after all workers finish
+    char *report;
+    size_t report_len;
+} VerifyChunk;
+
+static const char *format_names[] = { "auto", "hex", "jsonl", "bin" };
+
+static int hex_value(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool is_space(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// "HEXKEY ADDRESS": fills secret and the address as written
+static int parse_hex_line(const uint8_t *p, size_t len, uint8_t *secret, char *address) {
+    if (len < SOLANA_PRIVKEY_SIZE * 2 + 1) {
+        return -1;
+    }
+
+    for (int i = 0; i < SOLANA_PRIVKEY_SIZE; i++) {
+        int hi = hex_value(p[2 * i]);
+        int lo = hex_value(p[2 * i + 1]);
+        if (hi < 0 || lo < 0) {
+            return -1;
+        }
+        secret[i] = (uint8_t)((hi << 4) | lo);
+    }
+
+    size_t pos = SOLANA_PRIVKEY_SIZE * 2;
+    if (!is_space(p[pos])) {
+        return -1;
+    }
+    while (pos < len && is_space(p[pos])) {
+        pos++;
+    }
+
+    size_t addr_len = 0;
+    while (pos + addr_len < len && !is_space(p[pos + addr_len])) {
+        addr_len++;
+    }
+    if (addr_len == 0 || addr_len > 44) {
+        return -1;
+    }
+
+    // Nothing but whitespace may follow the address
+    for (size_t i = pos + addr_len; i < len; i++) {
+        if (!is_space(p[i])) {
+            return -1;
+        }
+    }
+
+    memcpy(address, p + pos, addr_len);
+    address[addr_len] = '\0';
+    return 0;
+}
+
+// "[n,n,...]" with 64 byte values: the first 32 are the secret, the rest the pubkey
+static int parse_json_line(const uint8_t *p, size_t len, uint8_t *record) {
+    size_t pos = 0;
+    while (pos < len && is_space(p[pos])) pos++;
+    if (pos == len || p[pos++] != '[') {
+        return -1;
+    }
+
+    for (int i = 0; i < VERIFY_RECORD_SIZE; i++) {
+        while (pos < len && is_space(p[pos])) pos++;
+
+        unsigned value = 0;
+        size_t digits = 0;
+        while (pos < len && p[pos] >= '0' && p[pos] <= '9' && digits < 4) {
+            value = value * 10 + (p[pos++] - '0');
+            digits++;
+        }
+        if (digits == 0 || value > 255) {
+            return -1;
+        }
+        record[i] = (uint8_t)value;
+
+        while (pos < len && is_space(p[pos])) pos++;
+        if (pos == len) {
+            return -1;
+        }
+        uint8_t expected = (i == VERIFY_RECORD_SIZE - 1) ? ']' : ',';
+        if (p[pos++] != expected) {
+            return -1;
+        }
+    }
+
+    while (pos < len && is_space(p[pos])) pos++;
+    return pos == len ? 0 : -1;
+}
+
+VerifyFormat verify_detect_format(const uint8_t *data, size_t size) {
+    size_t i = 0;
+    while (i < size && (is_space(data[i]) || data[i] == '\n')) {
+        i++;
+    }
+
+    // A text format only counts if its first line actually parses; binary secrets
+    // can start with '[' or hex digits just as well
+    const uint8_t *nl = (i < size) ? memchr(data + i, '\n', size - i) : NULL;
+    size_t line_len = nl ? (size_t)(nl - (data + i)) : size - i;
+
+    if (line_len > 0) {
+        uint8_t record[VERIFY_RECORD_SIZE];
+        char address[64];
+        if (parse_json_line(data + i, line_len, record) == 0) {
+            return VERIFY_FORMAT_JSONL;
+        }
+        if (parse_hex_line(data + i, line_len, record, address) == 0) {
+            return VERIFY_FORMAT_HEX;
+        }
+    }
+
+    if (size > 0 && size % VERIFY_RECORD_SIZE == 0) {
+        return VERIFY_FORMAT_BIN;
+    }
+
+    return VERIFY_FORMAT_AUTO; // Unknown
+}
+
+static void report_mismatch(const VerifyChunk *chunk, size_t record, const char *reason, const char *detail) {
+    // Text formats count lines from 1, binary records from 0
+    const char *unit = (chunk->format == VERIFY_FORMAT_BIN) ? "record" : "line";
+    size_t n = (chunk->format == VERIFY_FORMAT_BIN) ? record : record + 1;
+    if (detail) {
+        fprintf(chunk->out, "%s %zu: %s (%s)\n", unit, n, reason, detail);
+    } else {
+        fprintf(chunk->out, "%s %zu: %s\n", unit, n, reason);
+    }
+}
+
+// Re-derive the pubkey and compare it (and, if requested, the pattern) with what was recorded.
+// Exactly one of expected_pubkey / expected_address is set.
+static void verify_record(VerifyChunk *chunk, size_t record, const uint8_t *secret,
+                          const uint8_t *expected_pubkey, const char *expected_address) {
+    uint8_t pubkey[SOLANA_PUBKEY_SIZE];
+    char address[64];
+
+    chunk->records++;
+    secret_to_pubkey_solana(secret, pubkey);
+
+    if (expected_pubkey) {
+        if (memcmp(pubkey, expected_pubkey, SOLANA_PUBKEY_SIZE) != 0) {
+            char recorded[64];
+            pubkey_to_base58(expected_pubkey, recorded);
+            report_mismatch(chunk, record, "pubkey mismatch", recorded);
+            chunk->mismatches++;
+            return;
+        }
+    } else {
+        pubkey_to_base58(pubkey, address);
+        if (strcmp(address, expected_address) != 0) {
+            report_mismatch(chunk, record, "address mismatch", expected_address);
+            chunk->mismatches++;
+            return;
+        }
+    }
+
+    // Same match/confirm step as the search workers
+    if (chunk->matcher) {
+        if (match_pubkey_batch(chunk->matcher, chunk->prefix, pubkey, 0, 1, address) != 0) {
+            report_mismatch(chunk, record, "pattern mismatch", NULL);
+            chunk->mismatches++;
+        }
+    }
+}
+
+static void* verify_worker_thread(void *arg) {
+    VerifyChunk *chunk = (VerifyChunk *)arg;
+    const uint8_t *data = chunk->data;
+
+    if (chunk->format == VERIFY_FORMAT_BIN) {
+        size_t record = chunk->first_record;
+        for (size_t pos = chunk->begin; pos + VERIFY_RECORD_SIZE <= chunk->end; pos += VERIFY_RECORD_SIZE) {
+            verify_record(chunk, record++, data + pos, data + pos + SOLANA_PRIVKEY_SIZE, NULL);
+        }
+        return NULL;
+    }
+
+    size_t line = chunk->first_record;
+    size_t pos = chunk->begin;
+    while (pos < chunk->end) {
+        const uint8_t *nl = memchr(data + pos, '\n', chunk->end - pos);
+        size_t line_end = nl ? (size_t)(nl - data) : chunk->end;
+        const uint8_t *p = data + pos;
+        size_t len = line_end - pos;
+
+        // Skip blank lines
+        size_t k = 0;
+        while (k < len && is_space(p[k])) k++;
+
+        if (k < len) {
+            if (chunk->format == VERIFY_FORMAT_HEX) {
+                uint8_t secret[SOLANA_PRIVKEY_SIZE];
+                char address[64];
+                if (parse_hex_line(p + k, len - k, secret, address) == 0) {
+                    verify_record(chunk, line, secret, NULL, address);
+                } else {
+                    chunk->records++;
+                    chunk->mismatches++;
+                    report_mismatch(chunk, line, "malformed record", NULL);
+                }
+            } else {
+                uint8_t record[VERIFY_RECORD_SIZE];
+                if (parse_json_line(p + k, len - k, record) == 0) {
+                    verify_record(chunk, line, record, record + SOLANA_PRIVKEY_SIZE, NULL);
+                } else {
+                    chunk->records++;
+                    chunk->mismatches++;
+                    report_mismatch(chunk, line, "malformed record", NULL);
+                }
+            }
+        }
+
+        line++;
+        pos = line_end + 1;
+    }
+
+    return NULL;
+}
+
+// Split [0, size) into num_chunks ranges; text chunks start right after a newline
+static size_t split_chunks(const uint8_t *data, size_t size, VerifyFormat format, VerifyChunk *chunks, size_t num_chunks) {
+    size_t n = 0;
+    size_t pos = 0;
+    size_t record = 0;
+
+    for (size_t i = 0; i < num_chunks && pos < size; i++) {
+        size_t end;
+        if (format == VERIFY_FORMAT_BIN) {
+            size_t total = size / VERIFY_RECORD_SIZE;
+            size_t per_chunk = (total + num_chunks - 1) / num_chunks;
+            end = pos + per_chunk * VERIFY_RECORD_SIZE;
+            if (end > size) end = size;
+        } else {
+            end = (i == num_chunks - 1) ? size : (size / num_chunks) * (i + 1);
+            if (end < pos) end = pos;
+            const uint8_t *nl = (end < size) ? memchr(data + end, '\n', size - end) : NULL;
+            end = nl ? (size_t)(nl - data) + 1 : size;
+        }
+
+        chunks[n].begin = pos;
+        chunks[n].end = end;
+        chunks[n].first_record = record;
+        n++;
+
+        // Advance the record counter past this chunk
+        if (format == VERIFY_FORMAT_BIN) {
+            record += (end - pos) / VERIFY_RECORD_SIZE;
+        } else {
+            for (const uint8_t *p = data + pos; (p = memchr(p, '\n', (data + end) - p)) != NULL; p++) {
+                record++;
+            }
+        }
+        pos = end;
+    }
+
+    return n;
+}
+
+int verify_main(int argc, char *argv[]) {
+    struct arg_lit  *help    = arg_lit0("h", "help", "display this help and exit");
+    struct arg_file *file    = arg_file1(NULL, NULL, "FILE", "Keypair output file to verify");
+    struct arg_str  *format  = arg_str0("f", "format", "FORMAT", "hex, jsonl or bin [default: detect from contents]");
+    struct arg_str  *prefix  = arg_str0("p", "prefix", "PREFIX", "Also check every address matches this prefix");
+    struct arg_int  *threads = arg_int0("t", "threads", "N", "The number of threads to use [default: number of cores]");
+    struct arg_end  *end     = arg_end(20);
+
+    void *argtable[] = { file, format, prefix, threads, help, end };
+
+    const char *progname = "solana-vanity verify";
+
+    int nerrors = arg_parse(argc, argv, argtable);
+
+    if (help->count > 0) {
+        printf("Usage: %s", progname);
+        arg_print_syntax(stdout, argtable, "\n");
+        printf("%s\n\n", "Re-derive every keypair in FILE and report mismatches (exit status 2 if any)");
+        arg_print_glossary(stdout, argtable, "  %-25s %s\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 0;
+    }
+
+    if (nerrors > 0) {
+        arg_print_errors(stdout, end, progname);
+        printf("Try '%s --help' for more information.\n", progname);
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    int ret = 1;
+    const char *path = file->filename[0];
+    uint8_t *data = MAP_FAILED;
+    size_t size = 0;
+    SolanaMatcher matcher = { 0 };
+    bool use_matcher = (prefix->count > 0);
+
+    VerifyFormat fmt = VERIFY_FORMAT_AUTO;
+    if (format->count > 0) {
+        for (int i = VERIFY_FORMAT_HEX; i <= VERIFY_FORMAT_BIN; i++) {
+            if (strcmp(format->sval[0], format_names[i]) == 0) {
+                fmt = (VerifyFormat)i;
+            }
+        }
+        if (fmt == VERIFY_FORMAT_AUTO) {
+            fprintf(stderr, "Unknown format: %s (expected hex, jsonl or bin)\n", format->sval[0]);
+            goto done;
+        }
+    }
+
+    if (use_matcher && prefix_to_all_ranges(prefix->sval[0], &matcher) != 0) {
+        fprintf(stderr, "Failed to create matcher for prefix: %s\n", prefix->sval[0]);
+        goto done;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Couldn't open %s\n", path);
+        goto done;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        fprintf(stderr, "No records in %s\n", path);
+        close(fd);
+        goto done;
+    }
+    size = (size_t)st.st_size;
+
+    data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Couldn't map %s\n", path);
+        goto done;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    if (fmt == VERIFY_FORMAT_AUTO) {
+        fmt = verify_detect_format(data, size);
+        if (fmt == VERIFY_FORMAT_AUTO) {
+            fprintf(stderr, "Couldn't detect the format of %s, use --format\n", path);
+            goto done;
+        }
+    }
+    if (fmt == VERIFY_FORMAT_BIN && size % VERIFY_RECORD_SIZE != 0) {
+        fprintf(stderr, "%s: size is not a multiple of %d bytes\n", path, VERIFY_RECORD_SIZE);
+        goto done;
+    }
+
+    int num_threads = threads->count > 0 ? threads->ival[0] : sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_threads < 1) num_threads = 1;
+
+    VerifyChunk *chunks = calloc(num_threads, sizeof(VerifyChunk));
+    pthread_t *workers = malloc(sizeof(pthread_t) * num_threads);
+    size_t num_chunks = split_chunks(data, size, fmt, chunks, num_threads);
+
+    fprintf(stderr, "Verifying %s (%s) with %zu thread(s)\n", path, format_names[fmt], num_chunks);
+    fflush(stderr);
+
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (size_t i = 0; i < num_chunks; i++) {
+        chunks[i].out = open_memstream(&chunks[i].report, &chunks[i].report_len);
+        if (!chunks[i].out) {
+            fprintf(stderr, "Couldn't allocate the mismatch report\n");
+            exit(1);
+        }
+        chunks[i].data = data;
+        chunks[i].format = fmt;
+        chunks[i].matcher = use_matcher ? &matcher : NULL;
+        chunks[i].prefix = use_matcher ? prefix->sval[0] : NULL;
+        pthread_create(&workers[i], NULL, verify_worker_thread, &chunks[i]);
+    }
+
+    size_t records = 0;
+    size_t mismatches = 0;
+    for (size_t i = 0; i < num_chunks; i++) {
+        pthread_join(workers[i], NULL);
+        records += chunks[i].records;
+        mismatches += chunks[i].mismatches;
+    }
+
+    // Chunks cover the file in order, so this reports mismatches in file order
+    for (size_t i = 0; i < num_chunks; i++) {
+        fclose(chunks[i].out);
+        fwrite(chunks[i].report, 1, chunks[i].report_len, stdout);
+        free(chunks[i].report);
+    }
+    fflush(stdout);
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsed = (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) / 1e9;
+
+    fprintf(stderr, "Verified %zu record(s) in %.3f s (%.1f records/s): %zu mismatch(es)\n",
+            records, elapsed, (elapsed > 0) ? (records / elapsed) : 0.0, mismatches);
+
+    free(chunks);
+    free(workers);
+    ret = (mismatches > 0) ? 2 : 0;
+
+done:
+    if (data != MAP_FAILED) {
+        munmap(data, size);
+    }
+    solana_matcher_free(&matcher);
+    arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+    return ret;
+}
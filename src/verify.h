@@ -0,0 +1,21 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef enum {
+    VERIFY_FORMAT_AUTO,
+    VERIFY_FORMAT_HEX,   // "[key] [address]" lines, as written by --simple-output
+    VERIFY_FORMAT_JSONL, // One solana-keygen style 64-byte array per line
+    VERIFY_FORMAT_BIN    // Packed 64-byte records: 32-byte secret, 32-byte pubkey
+} VerifyFormat;
+
+// Guess the format of a keypair file from its contents
+VerifyFormat verify_detect_format(const uint8_t *data, size_t size);
+
+// Entry point for the "verify" subcommand
+int verify_main(int argc, char *argv[]);
+
+#endif